@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import math
+import numpy
+import os
+import subprocess
+import sys
+
+# The fixed set of named scenarios
+SCENARIOS = {
+  'empty-self': [
+    '/benchmark/component/type=string=empty'],
+  'empty-all': [
+    '/benchmark/component/type=string=empty',
+    '/benchmark/component/remote_probability=float=1'],
+  'simple-self': [
+    '/benchmark/component/type=string=simple'],
+  'simple-all': [
+    '/benchmark/component/type=string=simple',
+    '/benchmark/component/remote_probability=float=1'],
+  'mem1m-1b': [
+    '/benchmark/component/type=string=memory',
+    '/benchmark/component/bytes=uint=1000',
+    '/benchmark/component/size=uint=1'],
+  'mem100m-1b': [
+    '/benchmark/component/type=string=memory',
+    '/benchmark/component/bytes=uint=100000',
+    '/benchmark/component/size=uint=1'],
+  'bounce2': [
+    '/benchmark/component/type=string=empty',
+    '/benchmark/component/initial_events=uint=2',
+    '/benchmark/component/remote_probability=float=1'],
+  'bounce10': [
+    '/benchmark/component/type=string=empty',
+    '/benchmark/component/initial_events=uint=10',
+    '/benchmark/component/remote_probability=float=1'],
+}
+
+def main():
+  ap = argparse.ArgumentParser(
+    description='compares the throughput of two desbench programs')
+  ap.add_argument('base', help='baseline desbench program')
+  ap.add_argument('test', help='desbench program under test')
+  ap.add_argument('odir', help='the output directory')
+  ap.add_argument('-r', '--runs', type=int, default=10,
+                  help='number of runs per program and scenario')
+  ap.add_argument('-m', '--min_runs', type=int, default=10,
+                  help='minimum number of runs to flag regressions')
+  ap.add_argument('-e', '--exetime', type=int, default=10,
+                  help='execution time per run in seconds')
+  ap.add_argument('-c', '--cpus', type=int, default=os.cpu_count(),
+                  help='number of cpus (threads)')
+  ap.add_argument('-b', '--budget', type=float, default=0.0,
+                  help='allowed slowdown fraction before flagging')
+  ap.add_argument('-i', '--confidence', type=float, default=0.95,
+                  help='confidence level of the speedup interval')
+  ap.add_argument('-s', '--scenarios', nargs='+', default=sorted(SCENARIOS),
+                  choices=sorted(SCENARIOS), help='scenarios to run')
+  ap.add_argument('-n', '--numactl', default=None,
+                  help="arguments for numactl");
+  args = ap.parse_args();
+  assert args.runs >= 2, 'at least 2 runs are needed for an interval'
+
+  if not os.path.isdir(args.odir):
+    os.mkdir(args.odir)
+
+  # Makes the default settings
+  cfg_file = os.path.join(args.odir, 'settings.json')
+  with open(cfg_file, 'w') as fd:
+    cfg = {
+      'simulator': {
+        'execution_time': 'TBD',
+        'core': {
+          'executers': 'TBD',
+          'seed': 1234,
+          'observer_interval': 1.0,
+          'observer_power': 11
+        },
+        'mapper': {
+          'algorithm': 'round_robin'
+        },
+        'observer': {
+          'log_summary': True
+        },
+        'logger': {
+          'file': '-'
+        }
+      },
+      'benchmark': {
+        'num_components': 1000,
+        'topology': 'all-to-all',
+        'component': {
+          'type': 'TBD',
+          'initial_events': 1,
+          'look_ahead': 1,
+          'stagger_tick': False,
+          'stagger_epsilon': False,
+          'remote_probability': 0.0
+        }
+      },
+      'debug': []
+    }
+    json.dump(cfg, fd, indent=2)
+
+  # Runs the programs one at a time, alternating which goes first in each
+  # round so that slow drifts of the machine affect both equally.
+  exes = {'base': args.base, 'test': args.test}
+  rates = {scenario: {'base': [], 'test': []} for scenario in args.scenarios}
+  for run in range(0, args.runs):
+    order = ['base', 'test'] if run % 2 == 0 else ['test', 'base']
+    for scenario in args.scenarios:
+      for which in order:
+        name = '{0}_{1}_{2}'.format(scenario, which, run)
+        filename = os.path.join(args.odir, name + '.log')
+        cmd = []
+        if args.numactl:
+          cmd += ['numactl'] + args.numactl.split()
+        cmd += [exes[which], cfg_file]
+        cmd += ['/simulator/execution_time=float={}'.format(args.exetime)]
+        cmd += ['/simulator/core/executers=uint={}'.format(args.cpus)]
+        cmd += SCENARIOS[scenario]
+        print(name)
+        with open(filename, 'w') as fd:
+          subprocess.run(cmd, stdout=fd, stderr=subprocess.STDOUT, check=True)
+        rates[scenario][which].append(extractRate(filename))
+
+  # Computes the speedup of each scenario
+  flagging = args.runs >= args.min_runs
+  results = []
+  for scenario in args.scenarios:
+    base = numpy.array(rates[scenario]['base'])
+    test = numpy.array(rates[scenario]['test'])
+    speedup = test.mean() / base.mean()
+    low, high = speedupInterval(base, test, args.confidence)
+    if high < 1.0 - args.budget and flagging:
+      status = 'REGRESSION'
+    elif high < 1.0:
+      status = 'slower'
+    elif low > 1.0:
+      status = 'faster'
+    else:
+      status = 'same'
+    results.append((scenario, base.mean(), test.mean(), speedup, low, high,
+                    status))
+
+  # print the CSV file
+  with open(os.path.join(args.odir, 'compare.csv'), 'w') as fd:
+    print('Benchmark,Base,Test,Speedup,Low,High,Status', file=fd)
+    for result in results:
+      print('{},{},{},{},{},{},{}'.format(*result), file=fd)
+
+  # print the summary
+  print('{:<12} {:>14} {:>14} {:>8}  {:>17}  {}'.format(
+    'Benchmark', 'Base', 'Test', 'Speedup',
+    '{:.0f}% interval'.format(args.confidence * 100), 'Status'))
+  for result in results:
+    print('{:<12} {:>14.1f} {:>14.1f} {:>8.4f}  [{:.4f}, {:.4f}]  {}'.format(
+      *result))
+
+  if not flagging:
+    print('Regressions are not flagged with fewer than {} runs'.format(
+      args.min_runs))
+  regressions = [result[0] for result in results if result[-1] == 'REGRESSION']
+  if regressions:
+    print('Regressions: {}'.format(', '.join(regressions)))
+    return -1
+  return 0
+
+
+def speedupInterval(base, test, confidence):
+  # Welch's t-interval on the log of the ratio of the means. The variance of
+  # the log of each mean comes from the delta method.
+  var_base = base.var(ddof=1) / (len(base) * base.mean() ** 2)
+  var_test = test.var(ddof=1) / (len(test) * test.mean() ** 2)
+  log_ratio = math.log(test.mean() / base.mean())
+  stderr = math.sqrt(var_base + var_test)
+  if stderr == 0:
+    return (math.exp(log_ratio), math.exp(log_ratio))
+  dof = (var_base + var_test) ** 2 / (
+    var_base ** 2 / (len(base) - 1) + var_test ** 2 / (len(test) - 1))
+  margin = studentTQuantile(0.5 + confidence / 2, dof) * stderr
+  return (math.exp(log_ratio - margin), math.exp(log_ratio + margin))
+
+
+def studentTQuantile(prob, dof):
+  # Inverts the Student's t CDF by bisection (prob > 0.5).
+  low, high = 0.0, 1.0
+  while studentTCdf(high, dof) < prob:
+    high *= 2
+  for _ in range(100):
+    mid = (low + high) / 2
+    if studentTCdf(mid, dof) < prob:
+      low = mid
+    else:
+      high = mid
+  return (low + high) / 2
+
+
+def studentTCdf(t, dof):
+  # For t >= 0 using the regularized incomplete beta function.
+  return 1.0 - 0.5 * incompleteBeta(dof / 2, 0.5, dof / (dof + t * t))
+
+
+def incompleteBeta(a, b, x):
+  # Regularized incomplete beta function via its continued fraction.
+  if x <= 0.0:
+    return 0.0
+  if x >= 1.0:
+    return 1.0
+  front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) +
+                   a * math.log(x) + b * math.log(1.0 - x))
+  if x > (a + 1) / (a + b + 2):
+    return 1.0 - incompleteBeta(b, a, 1.0 - x)
+  tiny = 1e-300
+  c = 1.0
+  d = 1.0 - (a + b) * x / (a + 1)
+  d = 1.0 / (d if abs(d) > tiny else tiny)
+  f = d
+  for m in range(1, 300):
+    for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                      -(a + m) * (a + b + m) * x /
+                      ((a + 2 * m) * (a + 2 * m + 1))):
+      d = 1.0 + numerator * d
+      d = 1.0 / (d if abs(d) > tiny else tiny)
+      c = 1.0 + numerator / c
+      c = c if abs(c) > tiny else tiny
+      f *= c * d
+    if abs(c * d - 1.0) < 1e-15:
+      break
+  return front * f / a
+
+
+def extractRate(filename):
+  with open(filename, 'r') as fd:
+    for line in fd:
+      if line.find('Events per second') == 0:
+        words = line.split()
+        return float(words[-1])
+  assert False, 'Never found the keywords in {}'.format(filename)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
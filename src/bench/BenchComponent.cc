@@ -30,6 +30,7 @@
  */
 #include "bench/BenchComponent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstring>
@@ -46,11 +47,22 @@ BenchComponent::BenchComponent(des::Simulator* _simulator,
       stagger_tick_(_settings["stagger_tick"].get<bool>()),
       stagger_epsilon_(_settings["stagger_epsilon"].get<bool>()),
       remote_probability_(_settings["remote_probability"].get<f64>()),
+      random_batch_(_settings.contains("random_batch")
+                        ? _settings["random_batch"].get<u64>()
+                        : 0),
       count_(0),
       run_(true),
-      num_dests_(0) {
+      num_dests_(0),
+      schedule_(nullptr),
+      phase_lines_(0),
+      stream_seed_(0) {
   assert(look_ahead_ > 0);
   assert(remote_probability_ >= 0.0 && remote_probability_ <= 1.0);
+  if (random_batch_ > 0) {
+    // Components are created in order so the seeds are deterministic.
+    stream_seed_ = simulator->random()->nextU64();
+    createStreams(initial_events_);
+  }
 }
 
 BenchComponent* BenchComponent::create(des::Simulator* _simulator,
@@ -75,19 +87,77 @@ void BenchComponent::setDestinationComponents(
     const std::vector<BenchComponent*>& _dest_components) {
   num_dests_ = _dest_components.size();
   dest_components_ = _dest_components;
+  // Keeps the destinations ordered by ID so the active destinations of each
+  // phase are a prefix.
+  std::sort(dest_components_.begin(), dest_components_.end(),
+            [](const BenchComponent* _a, const BenchComponent* _b) {
+              return _a->id_ < _b->id_;
+            });
+}
+
+void BenchComponent::setSchedule(Schedule* _schedule) {
+  schedule_ = _schedule;
+
+  // Each event counts separately because the events of a component may be
+  // handled concurrently by different executers.
+  u64 num_phases = schedule_->numPhases();
+  phase_lines_ = (num_phases + 7) / 8;
+  phase_counts_.assign(schedule_->maxEvents() * phase_lines_, PhaseCounts());
+
+  // Counts the active destinations of each phase.
+  active_dests_.clear();
+  for (u32 phase = 0; phase < num_phases; phase++) {
+    u64 active_components = schedule_->phase(phase).active_components;
+    u64 active_dests = 0;
+    while (active_dests < num_dests_ &&
+           dest_components_.at(active_dests)->id_ < active_components) {
+      active_dests++;
+    }
+    active_dests_.push_back(active_dests);
+  }
+
+  if (random_batch_ > 0) {
+    createStreams(schedule_->maxEvents());
+  }
+}
+
+u64 BenchComponent::phaseCount(u32 _phase) const {
+  u64 count = 0;
+  for (u64 line = _phase / 8; line < phase_counts_.size();
+       line += phase_lines_) {
+    count += phase_counts_.at(line).counts[_phase % 8];
+  }
+  return count;
 }
 
+void BenchComponent::report() {}
+
 u64 BenchComponent::initialEvents() {
+  if (schedule_ != nullptr) {
+    // Enough events are created for the busiest phase.
+    return schedule_->maxEvents();
+  }
   return initial_events_;
 }
 
-des::Time BenchComponent::nextTime() {
+u32 BenchComponent::currentPhase() {
+  if (schedule_ == nullptr) {
+    return 0;
+  }
+  return schedule_->current(simulator->time().tick());
+}
+
+des::Time BenchComponent::nextTime(u32 _phase) {
+  des::Tick look_ahead = look_ahead_;
+  if (schedule_ != nullptr) {
+    look_ahead = schedule_->phase(_phase).look_ahead;
+  }
   des::Time time;
   if (stagger_tick_) {
-    time.setTick(simulator->time().tick() + look_ahead_ +
+    time.setTick(simulator->time().tick() + look_ahead +
                  (id_ % des::TICK_INV));
   } else {
-    time.setTick(simulator->time().tick() + look_ahead_);
+    time.setTick(simulator->time().tick() + look_ahead);
   }
   if (stagger_epsilon_) {
     time.setEpsilon((id_ + count_) % des::EPSILON_INV);
@@ -97,10 +167,74 @@ des::Time BenchComponent::nextTime() {
   return time;
 }
 
-BenchComponent* BenchComponent::nextComponent() {
-  if (simulator->random()->nextF64() <= remote_probability_) {
-    u64 id = simulator->random()->nextU64() % num_dests_;
+BenchComponent* BenchComponent::nextComponent(u64 _event, u32 _phase) {
+  f64 remote_probability = remote_probability_;
+  u64 num_dests = num_dests_;
+  if (schedule_ != nullptr) {
+    // Only active components are destinations.
+    remote_probability = schedule_->phase(_phase).remote_probability;
+    num_dests = active_dests_[_phase];
+  }
+  if (num_dests > 0 && randomF64(_event) <= remote_probability) {
+    u64 id = randomU64(_event) % num_dests;
     return dest_components_.at(id);
   }
   return this;
 }
+
+u64 BenchComponent::randomU64(u64 _event) {
+  if (random_batch_ == 0) {
+    return simulator->random()->nextU64();
+  }
+  return streams_[_event].nextU64();
+}
+
+u64 BenchComponent::randomU64(u64 _event, u64 _min, u64 _max) {
+  if (random_batch_ == 0) {
+    return simulator->random()->nextU64(_min, _max);
+  }
+  return streams_[_event].nextU64(_min, _max);
+}
+
+f64 BenchComponent::randomF64(u64 _event) {
+  if (random_batch_ == 0) {
+    return simulator->random()->nextF64();
+  }
+  return streams_[_event].nextF64();
+}
+
+bool BenchComponent::admit(u64 _event, u32 _phase) {
+  if (schedule_ == nullptr) {
+    return true;
+  }
+  if (!schedule_->admits(_phase, id_, _event)) {
+    return false;
+  }
+  phase_counts_[_event * phase_lines_ + _phase / 8].counts[_phase % 8]++;
+  return true;
+}
+
+bool BenchComponent::parkTime(u64 _event, u32 _phase, des::Time* _time) {
+  u32 next = schedule_->nextAdmitting(_phase, id_, _event);
+  if (next == schedule_->numPhases()) {
+    return false;
+  }
+  if (schedule_->tickUnits()) {
+    // Sleeps until the phase that uses this event starts.
+    *_time = des::Time(schedule_->phase(next).start_tick);
+  } else {
+    // Wall-clock phases can't be predicted so the event wakes up periodically.
+    *_time = des::Time(simulator->time().tick() + schedule_->parkInterval());
+  }
+  return true;
+}
+
+void BenchComponent::createStreams(u64 _events) {
+  // Each event has its own stream because the events of a component may be
+  // handled concurrently by different executers.
+  streams_.clear();
+  streams_.reserve(_events);
+  for (u64 event = 0; event < _events; event++) {
+    streams_.emplace_back(stream_seed_ + event, random_batch_);
+  }
+}
@@ -34,6 +34,8 @@
 #include <string>
 #include <vector>
 
+#include "bench/RandomStream.h"
+#include "bench/Schedule.h"
 #include "des/des.h"
 #include "nlohmann/json.hpp"
 #include "prim/prim.h"
@@ -53,10 +55,34 @@ class BenchComponent : public des::ActiveComponent {
   void setDestinationComponents(
       const std::vector<BenchComponent*>& _dest_components);
 
+  void setSchedule(Schedule* _schedule);
+  u64 phaseCount(u32 _phase) const;
+
+  // Prints component specific results after the simulation completes.
+  virtual void report();
+
  protected:
   u64 initialEvents();
-  des::Time nextTime();
-  BenchComponent* nextComponent();
+
+  // Returns the current schedule phase (always 0 without a schedule). This is
+  // computed once per event and passed to the functions below.
+  u32 currentPhase();
+  des::Time nextTime(u32 _phase);
+  BenchComponent* nextComponent(u64 _event, u32 _phase);
+
+  // Random numbers for event number '_event' of this component. These come
+  // from the simulator unless 'random_batch' is set, in which case each event
+  // of each component has its own batched stream.
+  u64 randomU64(u64 _event);
+  u64 randomU64(u64 _event, u64 _min, u64 _max);
+  f64 randomF64(u64 _event);
+
+  // Returns true if event number '_event' of this component should do work in
+  // phase '_phase'. Otherwise, the event should be parked.
+  bool admit(u64 _event, u32 _phase);
+  // Sets the time a parked event should wake up. Returns false if no later
+  // phase uses the event, in which case it should be dropped.
+  bool parkTime(u64 _event, u32 _phase, des::Time* _time);
 
   const u64 id_;
   const u64 initial_events_;
@@ -64,11 +90,28 @@ class BenchComponent : public des::ActiveComponent {
   const bool stagger_tick_;
   const bool stagger_epsilon_;
   const f64 remote_probability_;
+  const u64 random_batch_;
 
   u64 count_;
   bool run_;
   u64 num_dests_;
   std::vector<BenchComponent*> dest_components_;
+
+  Schedule* schedule_;
+  // Per-phase event counts of each event. Each event's counts start on their
+  // own cache line.
+  struct alignas(64) PhaseCounts {
+    u64 counts[8];
+  };
+  u64 phase_lines_;  // cache lines per event
+  std::vector<PhaseCounts> phase_counts_;
+  std::vector<u64> active_dests_;  // per phase
+
+ private:
+  void createStreams(u64 _events);
+
+  u64 stream_seed_;
+  std::vector<RandomStream> streams_;
 };
 
 #endif  // BENCH_BENCHCOMPONENT_H_
@@ -45,25 +45,38 @@ void EmptyComponent::initialize() {
   u64 initial_events = initialEvents();
   for (u64 e = 0; e < initial_events; e++) {
     simulator->addEvent(new des::Event(
-        this, std::bind(&EmptyComponent::handler, this), des::Time(0), true));
+        this, std::bind(&EmptyComponent::handler, this, e), des::Time(0),
+        true));
   }
 }
 
-void EmptyComponent::handler() {
-  count_++;
-  dlogf("hello world, from component #%lu, count %lu", id_, count_);
+void EmptyComponent::handler(u64 _event) {
+  u32 phase = currentPhase();
+  bool work = admit(_event, phase);
+  if (work) {
+    count_++;
+    dlogf("hello world, from component #%lu, count %lu", id_, count_);
+  }
 
   if (run_) {
-    nextEvent();
+    nextEvent(_event, phase, work);
   }
 }
 
-void EmptyComponent::nextEvent() {
-  EmptyComponent* component =
-      reinterpret_cast<EmptyComponent*>(nextComponent());
-  des::Time time = nextTime();
+void EmptyComponent::nextEvent(u64 _event, u32 _phase, bool _work) {
+  EmptyComponent* component = this;
+  des::Time time;
+  if (_work) {
+    component =
+        reinterpret_cast<EmptyComponent*>(nextComponent(_event, _phase));
+    time = nextTime(_phase);
+  } else if (!parkTime(_event, _phase, &time)) {
+    // No later phase uses this event.
+    return;
+  }
   des::Event* event = new des::Event(
-      component, std::bind(&EmptyComponent::handler, this), time, true);
+      component, std::bind(&EmptyComponent::handler, this, _event), time,
+      true);
   simulator->addEvent(event);
 }
 
@@ -47,8 +47,8 @@ class EmptyComponent : public BenchComponent {
   void initialize() override;
 
  private:
-  void handler();
-  void nextEvent();
+  void handler(u64 _event);
+  void nextEvent(u64 _event, u32 _phase, bool _work);
 };
 
 #endif  // BENCH_EMPTYCOMPONENT_H_
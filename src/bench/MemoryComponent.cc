@@ -61,31 +61,44 @@ void MemoryComponent::initialize() {
   u64 initial_events = initialEvents();
   for (u64 e = 0; e < initial_events; e++) {
     simulator->addEvent(new des::Event(
-        this, std::bind(&MemoryComponent::handler, this), des::Time(0), true));
+        this, std::bind(&MemoryComponent::handler, this, e), des::Time(0),
+        true));
   }
 }
 
-void MemoryComponent::handler() {
-  count_++;
-  dlogf("hello world, from component #%lu, count %lu", id_, count_);
+void MemoryComponent::handler(u64 _event) {
+  u32 phase = currentPhase();
+  bool work = admit(_event, phase);
+  if (work) {
+    count_++;
+    dlogf("hello world, from component #%lu, count %lu", id_, count_);
 
-  // Uses memmove to transfer memory from a random source to a random
-  // destination.
-  u64 src = simulator->random()->nextU64(0, bytes_ - size_);
-  u64 dst = simulator->random()->nextU64(0, bytes_ - size_);
-  memmove(&mem_[dst], &mem_[src], size_);
+    // Uses memmove to transfer memory from a random source to a random
+    // destination.
+    u64 src = randomU64(_event, 0, bytes_ - size_);
+    u64 dst = randomU64(_event, 0, bytes_ - size_);
+    memmove(&mem_[dst], &mem_[src], size_);
+  }
 
   if (run_) {
-    nextEvent();
+    nextEvent(_event, phase, work);
   }
 }
 
-void MemoryComponent::nextEvent() {
-  MemoryComponent* component =
-      reinterpret_cast<MemoryComponent*>(nextComponent());
-  des::Time time = nextTime();
+void MemoryComponent::nextEvent(u64 _event, u32 _phase, bool _work) {
+  MemoryComponent* component = this;
+  des::Time time;
+  if (_work) {
+    component =
+        reinterpret_cast<MemoryComponent*>(nextComponent(_event, _phase));
+    time = nextTime(_phase);
+  } else if (!parkTime(_event, _phase, &time)) {
+    // No later phase uses this event.
+    return;
+  }
   des::Event* event = new des::Event(
-      component, std::bind(&MemoryComponent::handler, this), time, true);
+      component, std::bind(&MemoryComponent::handler, this, _event), time,
+      true);
   simulator->addEvent(event);
 }
 
@@ -47,8 +47,8 @@ class MemoryComponent : public BenchComponent {
   void initialize() override;
 
  private:
-  void handler();
-  void nextEvent();
+  void handler(u64 _event);
+  void nextEvent(u64 _event, u32 _phase, bool _work);
 
   u64 bytes_;  // total memory size in this component
   u64 size_;   // size of each transfer
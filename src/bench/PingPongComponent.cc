@@ -0,0 +1,201 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "bench/PingPongComponent.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cassert>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstring>
+
+#include "factory/ObjectFactory.h"
+
+namespace {
+
+u64 wallTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Round trip times are recorded in a log bucketed histogram with 16 linear
+// sub-buckets per power of two, so each bucket is within 6.25% of its values.
+const u64 kSubBits = 4;
+const u64 kSubBuckets = 1lu << kSubBits;
+const u64 kNumBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+u64 bucketOf(u64 _value) {
+  if (_value < kSubBuckets) {
+    return _value;
+  }
+  u64 exponent = 63 - __builtin_clzl(_value);
+  u64 sub = (_value >> (exponent - kSubBits)) & (kSubBuckets - 1);
+  return (exponent - kSubBits + 1) * kSubBuckets + sub;
+}
+
+u64 bucketFloor(u64 _bucket) {
+  if (_bucket < kSubBuckets) {
+    return _bucket;
+  }
+  u64 exponent = _bucket / kSubBuckets + kSubBits - 1;
+  u64 sub = _bucket % kSubBuckets;
+  return (kSubBuckets + sub) << (exponent - kSubBits);
+}
+
+// A send time that marks a kickoff event.
+const u64 kKickoff = 0;
+
+}  // namespace
+
+PingPongComponent::PingPongComponent(des::Simulator* _simulator,
+                                     const std::string& _name, u64 _id,
+                                     nlohmann::json _settings)
+    : BenchComponent(_simulator, _name, _id, _settings),
+      initiator_((_id % 2) == 0),
+      cpu_(-1),
+      round_trips_(kNumBuckets, 0),
+      num_round_trips_(0),
+      sum_round_trips_(0.0),
+      min_round_trip_(U64_MAX),
+      max_round_trip_(0) {}
+
+void PingPongComponent::setCpu(s32 _cpu) {
+  assert(_cpu >= 0);
+  cpu_ = _cpu;
+}
+
+void PingPongComponent::initialize() {
+  assert(num_dests_ == 1);
+  // Kickoff events start the bounces from within the simulation so the first
+  // round trips don't include the startup of the simulator. The responder's
+  // kickoff only pins its executer.
+  u64 initial_events = initiator_ ? initialEvents() : 1;
+  for (u64 e = 0; e < initial_events; e++) {
+    simulator->addEvent(new des::Event(
+        this, std::bind(&PingPongComponent::handler, this, kKickoff),
+        des::Time(0), true));
+  }
+}
+
+void PingPongComponent::report() {
+  if (!initiator_) {
+    return;
+  }
+  if (num_round_trips_ == 0) {
+    printf("Component #%lu round trips: none\n", id_);
+    return;
+  }
+  printf(
+      "Component #%lu round trips (ns): count=%lu mean=%.1f min=%lu p50=%lu "
+      "p90=%lu p99=%lu p99.9=%lu max=%lu\n",
+      id_, num_round_trips_, sum_round_trips_ / num_round_trips_,
+      min_round_trip_, percentile(0.50), percentile(0.90), percentile(0.99),
+      percentile(0.999), max_round_trip_);
+}
+
+void PingPongComponent::handler(u64 _send_time) {
+  count_++;
+  dlogf("hello world, from component #%lu, count %lu", id_, count_);
+
+  if (_send_time == kKickoff) {
+    pin();
+  }
+
+  if (initiator_) {
+    if (_send_time != kKickoff) {
+      // The event has made a full round trip.
+      record(wallTime() - _send_time);
+    }
+    if (run_) {
+      nextEvent(wallTime());
+    }
+  } else if (_send_time != kKickoff) {
+    // Returns the event to the initiator with its original send time.
+    if (run_) {
+      nextEvent(_send_time);
+    }
+  }
+}
+
+void PingPongComponent::nextEvent(u64 _send_time) {
+  PingPongComponent* partner =
+      reinterpret_cast<PingPongComponent*>(dest_components_.at(0));
+  des::Time time = nextTime(currentPhase());
+  des::Event* event = new des::Event(
+      partner, std::bind(&PingPongComponent::handler, partner, _send_time),
+      time, true);
+  simulator->addEvent(event);
+}
+
+void PingPongComponent::pin() {
+  if (cpu_ < 0) {
+    return;
+  }
+  // Pins the executer thread that is running this handler.
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_, &cpus);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+    fprintf(stderr, "unable to pin component #%lu to cpu %d\n", id_, cpu_);
+    assert(false);
+  }
+}
+
+void PingPongComponent::record(u64 _round_trip) {
+  round_trips_[bucketOf(_round_trip)]++;
+  num_round_trips_++;
+  sum_round_trips_ += _round_trip;
+  if (_round_trip < min_round_trip_) {
+    min_round_trip_ = _round_trip;
+  }
+  if (_round_trip > max_round_trip_) {
+    max_round_trip_ = _round_trip;
+  }
+}
+
+u64 PingPongComponent::percentile(f64 _percent) const {
+  // Returns the lower bound of the bucket holding the requested rank.
+  u64 rank = (u64)(_percent * (num_round_trips_ - 1));
+  u64 seen = 0;
+  for (u64 bucket = 0; bucket < round_trips_.size(); bucket++) {
+    seen += round_trips_[bucket];
+    if (seen > rank) {
+      return bucketFloor(bucket);
+    }
+  }
+  assert(false);
+  return 0;
+}
+
+registerWithObjectFactory("pingpong", BenchComponent, PingPongComponent,
+                          BENCH_ARGS);
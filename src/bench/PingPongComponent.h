@@ -0,0 +1,75 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BENCH_PINGPONGCOMPONENT_H_
+#define BENCH_PINGPONGCOMPONENT_H_
+
+#include <string>
+#include <vector>
+
+#include "bench/BenchComponent.h"
+#include "des/des.h"
+#include "nlohmann/json.hpp"
+#include "prim/prim.h"
+
+// This component bounces events with a single partner component. Components
+// with even IDs initiate the events and record the wall-clock round trip time
+// of each bounce into a fixed size histogram. Components with odd IDs return
+// each event to the sender. Optionally, each component pins the thread of its
+// executer to a chosen CPU before the first bounce.
+class PingPongComponent : public BenchComponent {
+ public:
+  PingPongComponent(des::Simulator* _simulator, const std::string& _name,
+                    u64 _id, nlohmann::json _settings);
+  ~PingPongComponent() override = default;
+
+  // Sets the CPU the executer of this component runs on.
+  void setCpu(s32 _cpu);
+
+  void initialize() override;
+  void report() override;
+
+ private:
+  void handler(u64 _send_time);
+  void nextEvent(u64 _send_time);
+  void pin();
+  void record(u64 _round_trip);
+  u64 percentile(f64 _percent) const;
+
+  const bool initiator_;
+  s32 cpu_;  // -1 when not pinned
+  std::vector<u64> round_trips_;  // histogram of nanoseconds
+  u64 num_round_trips_;
+  f64 sum_round_trips_;
+  u64 min_round_trip_;
+  u64 max_round_trip_;
+};
+
+#endif  // BENCH_PINGPONGCOMPONENT_H_
@@ -0,0 +1,123 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "bench/RandomStream.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+const u64 kGolden = 0x9e3779b97f4a7c15lu;
+
+// SplitMix64 mixer used for seeding.
+u64 mix64(u64 _z) {
+  _z = (_z ^ (_z >> 30)) * 0xbf58476d1ce4e5b9lu;
+  _z = (_z ^ (_z >> 27)) * 0x94d049bb133111eblu;
+  return _z ^ (_z >> 31);
+}
+
+// Two different 32-bit integer hashes (by Chris Wellons) for each half.
+u32 hashLow(u32 _x) {
+  _x ^= _x >> 16;
+  _x *= 0x7feb352du;
+  _x ^= _x >> 15;
+  _x *= 0x846ca68bu;
+  _x ^= _x >> 16;
+  return _x;
+}
+
+u32 hashHigh(u32 _x) {
+  _x ^= _x >> 16;
+  _x *= 0x21f0aaadu;
+  _x ^= _x >> 15;
+  _x *= 0x735a2d97u;
+  _x ^= _x >> 15;
+  return _x;
+}
+
+}  // namespace
+
+RandomStream::RandomStream(u64 _seed, u64 _batch)
+    : base_(mix64(_seed + kGolden)),
+      counter_(0),
+      index_(_batch),
+      batch_(_batch) {
+  assert(_batch > 0);
+}
+
+u64 RandomStream::nextU64() {
+  if (index_ == batch_.size()) {
+    refill();
+  }
+  return batch_[index_++];
+}
+
+u64 RandomStream::nextU64(u64 _min, u64 _max) {
+  assert(_min <= _max);
+  u64 span = _max - _min + 1;
+  if (span == 0) {
+    return nextU64();  // full range
+  }
+  return _min + (nextU64() % span);
+}
+
+f64 RandomStream::nextF64() {
+  // Uses the upper 53 bits to fill the mantissa.
+  return (nextU64() >> 11) * 0x1.0p-53;
+}
+
+void RandomStream::refill() {
+  // The upper half of the counter selects the hash keys so the inner fill
+  // loop only needs the lower half. Batches are split where it wraps.
+  u64 size = batch_.size();
+  u64 done = 0;
+  while (done < size) {
+    u64 counter = counter_ + done;
+    u32 position = (u32)counter;
+    u64 chunk = std::min(size - done, (1lu << 32) - position);
+    u64 key = mix64(base_ + (counter >> 32) * kGolden);
+    fill(&batch_[done], chunk, position, key);
+    done += chunk;
+  }
+  counter_ += size;
+  index_ = 0;
+}
+
+void RandomStream::fill(u64* _batch, u64 _size, u32 _position, u64 _key) {
+  u32 key_low = (u32)_key;
+  u32 key_high = (u32)(_key >> 32);
+  for (u64 idx = 0; idx < _size; idx++) {
+    u32 position = _position + (u32)idx;
+    u64 low = hashLow(position ^ key_low);
+    u64 high = hashHigh(position ^ key_high);
+    _batch[idx] = (high << 32) | low;
+  }
+}
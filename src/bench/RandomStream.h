@@ -0,0 +1,63 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BENCH_RANDOMSTREAM_H_
+#define BENCH_RANDOMSTREAM_H_
+
+#include <vector>
+
+#include "prim/prim.h"
+
+// This is a counter based random number stream that generates its numbers in
+// batches. Each number is a pure function of the seed and its position in the
+// stream, made from two 32-bit integer hashes of the position. The batch fill
+// loop has no serial dependency and only uses 32-bit multiplies, so it can be
+// vectorized for the baseline x86-64 (SSE2) target. GCC only vectorizes it at
+// -O2 with -ftree-vectorize (set by the build) or at -O3.
+class RandomStream {
+ public:
+  RandomStream(u64 _seed, u64 _batch);
+  ~RandomStream() = default;
+
+  u64 nextU64();
+  u64 nextU64(u64 _min, u64 _max);  // inclusive
+  f64 nextF64();                    // [0, 1)
+
+ private:
+  void refill();
+  void fill(u64* _batch, u64 _size, u32 _position, u64 _key);
+
+  u64 base_;
+  u64 counter_;
+  u64 index_;
+  std::vector<u64> batch_;
+};
+
+#endif  // BENCH_RANDOMSTREAM_H_
@@ -0,0 +1,108 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "bench/RandomStream.h"
+
+#include <set>
+
+#include "gtest/gtest.h"
+#include "prim/prim.h"
+
+TEST(RandomStream, sameSeed) {
+  RandomStream a(123, 16);
+  RandomStream b(123, 16);
+  RandomStream c(124, 16);
+  u64 same = 0;
+  for (u64 idx = 0; idx < 1000; idx++) {
+    u64 value = a.nextU64();
+    ASSERT_EQ(value, b.nextU64());
+    if (value == c.nextU64()) {
+      same++;
+    }
+  }
+  ASSERT_LT(same, 2u);
+}
+
+TEST(RandomStream, refill) {
+  // Small batches refill many times and must match one large batch.
+  RandomStream small(456, 7);
+  RandomStream large(456, 1000);
+  for (u64 idx = 0; idx < 1000; idx++) {
+    ASSERT_EQ(small.nextU64(), large.nextU64());
+  }
+}
+
+TEST(RandomStream, unique) {
+  RandomStream rs(789, 64);
+  std::set<u64> values;
+  for (u64 idx = 0; idx < 10000; idx++) {
+    values.insert(rs.nextU64());
+  }
+  ASSERT_EQ(values.size(), 10000u);
+}
+
+TEST(RandomStream, range) {
+  RandomStream rs(1, 32);
+  bool min_seen = false;
+  bool max_seen = false;
+  for (u64 idx = 0; idx < 10000; idx++) {
+    u64 value = rs.nextU64(10, 20);
+    ASSERT_GE(value, 10u);
+    ASSERT_LE(value, 20u);
+    min_seen |= value == 10;
+    max_seen |= value == 20;
+  }
+  ASSERT_TRUE(min_seen);
+  ASSERT_TRUE(max_seen);
+
+  for (u64 idx = 0; idx < 100; idx++) {
+    ASSERT_EQ(rs.nextU64(5, 5), 5u);
+  }
+
+  // The full range returns the raw numbers.
+  RandomStream full(2, 32);
+  RandomStream raw(2, 32);
+  for (u64 idx = 0; idx < 100; idx++) {
+    ASSERT_EQ(full.nextU64(0, U64_MAX), raw.nextU64());
+  }
+}
+
+TEST(RandomStream, f64) {
+  RandomStream rs(3, 128);
+  f64 sum = 0.0;
+  const u64 kDraws = 100000;
+  for (u64 idx = 0; idx < kDraws; idx++) {
+    f64 value = rs.nextF64();
+    ASSERT_GE(value, 0.0);
+    ASSERT_LT(value, 1.0);
+    sum += value;
+  }
+  ASSERT_NEAR(sum / kDraws, 0.5, 0.01);
+}
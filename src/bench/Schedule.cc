@@ -0,0 +1,234 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "bench/Schedule.h"
+
+#include <cassert>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+u64 wallTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+Schedule::Schedule(nlohmann::json _settings,
+                   nlohmann::json _component_settings, u64 _num_components,
+                   f64 _execution_time)
+    : tick_units_(_settings["units"].get<std::string>() == "tick"),
+      execution_time_(_execution_time),
+      park_interval_(0),
+      current_(0),
+      end_time_(0) {
+  const std::string units = _settings["units"].get<std::string>();
+  if (units != "tick" && units != "seconds") {
+    fprintf(stderr, "invalid schedule units: %s\n", units.c_str());
+    assert(false);
+  }
+  if (!tick_units_) {
+    // Tick phases are predictable so parked events sleep until they are used.
+    park_interval_ = _settings["park_interval"].get<des::Tick>();
+    assert(park_interval_ > 0);
+  }
+
+  // The first phase inherits the component settings.
+  Phase previous;
+  previous.start_tick = 0;
+  previous.start_time = 0.0;
+  previous.remote_probability =
+      _component_settings["remote_probability"].get<f64>();
+  previous.look_ahead = _component_settings["look_ahead"].get<des::Tick>();
+  previous.events = _component_settings["initial_events"].get<u64>();
+  previous.active_components = _num_components;
+
+  // Parses each phase.
+  for (nlohmann::json& phase_settings : _settings["phases"]) {
+    Phase phase = previous;
+    if (tick_units_) {
+      phase.start_tick = phase_settings["start"].get<des::Tick>();
+    } else {
+      phase.start_time = phase_settings["start"].get<f64>();
+    }
+    if (phase_settings.contains("remote_probability")) {
+      phase.remote_probability =
+          phase_settings["remote_probability"].get<f64>();
+    }
+    if (phase_settings.contains("look_ahead")) {
+      phase.look_ahead = phase_settings["look_ahead"].get<des::Tick>();
+    }
+    if (phase_settings.contains("events")) {
+      phase.events = phase_settings["events"].get<u64>();
+    }
+    if (phase_settings.contains("active_fraction")) {
+      f64 active_fraction = phase_settings["active_fraction"].get<f64>();
+      assert(active_fraction >= 0.0 && active_fraction <= 1.0);
+      phase.active_components =
+          (u64)std::round(active_fraction * _num_components);
+    }
+    assert(phase.remote_probability >= 0.0 && phase.remote_probability <= 1.0);
+    assert(phase.look_ahead > 0);
+    if (phases_.empty()) {
+      assert(phase.start_tick == 0 && phase.start_time == 0.0);
+    } else if (tick_units_) {
+      assert(phase.start_tick > previous.start_tick);
+    } else {
+      assert(phase.start_time > previous.start_time);
+    }
+    phases_.push_back(phase);
+    previous = phase;
+  }
+  assert(!phases_.empty());
+
+  // Phase start times are recorded as they are reached.
+  start_times_ = std::vector<std::atomic<u64>>(phases_.size());
+  for (std::atomic<u64>& start_time : start_times_) {
+    start_time.store(0);
+  }
+}
+
+bool Schedule::tickUnits() const {
+  return tick_units_;
+}
+
+u32 Schedule::numPhases() const {
+  return phases_.size();
+}
+
+const Schedule::Phase& Schedule::phase(u32 _phase) const {
+  return phases_.at(_phase);
+}
+
+bool Schedule::admits(u32 _phase, u64 _id, u64 _event) const {
+  const Phase& phase = phases_[_phase];
+  return _id < phase.active_components && _event < phase.events;
+}
+
+u32 Schedule::nextAdmitting(u32 _phase, u64 _id, u64 _event) const {
+  u32 next = _phase + 1;
+  while (next < phases_.size() && !admits(next, _id, _event)) {
+    next++;
+  }
+  return next;
+}
+
+u64 Schedule::maxEvents() const {
+  u64 max_events = 0;
+  for (const Phase& phase : phases_) {
+    if (phase.events > max_events) {
+      max_events = phase.events;
+    }
+  }
+  return max_events;
+}
+
+des::Tick Schedule::parkInterval() const {
+  return park_interval_;
+}
+
+u32 Schedule::current(des::Tick _tick) {
+  if (!tick_units_) {
+    return current_.load(std::memory_order_relaxed);
+  }
+  // The first phase always starts at tick 0 so this terminates.
+  u32 phase = phases_.size() - 1;
+  while (_tick < phases_[phase].start_tick) {
+    phase--;
+  }
+  if (start_times_[phase].load(std::memory_order_relaxed) == 0) {
+    markStart(phase);
+  }
+  return phase;
+}
+
+void Schedule::begin() {
+  start_times_[0].store(wallTime());
+  if (!tick_units_ && phases_.size() > 1) {
+    advancer_ = std::thread(&Schedule::advance, this);
+  }
+}
+
+void Schedule::end() {
+  if (advancer_.joinable()) {
+    advancer_.join();
+  }
+  end_time_ = wallTime();
+}
+
+void Schedule::report(const std::vector<u64>& _counts) const {
+  assert(_counts.size() == phases_.size());
+  for (u32 phase = 0; phase < phases_.size(); phase++) {
+    u64 start = start_times_[phase].load();
+    if (start == 0) {
+      printf("Phase %u: not reached\n", phase);
+      continue;
+    }
+    // The phase ends when the next reached phase starts.
+    u64 stop = end_time_;
+    for (u32 next = phase + 1; next < phases_.size(); next++) {
+      u64 next_start = start_times_[next].load();
+      if (next_start != 0) {
+        stop = next_start;
+        break;
+      }
+    }
+    f64 seconds = (stop - start) / 1e9;
+    printf("Phase %u: %lu events in %.3f seconds, events per second %.1f\n",
+           phase, _counts.at(phase), seconds, _counts.at(phase) / seconds);
+  }
+}
+
+void Schedule::advance() {
+  // Switches phases at their wall-clock offsets. Phases that start after the
+  // simulation ends are never reached.
+  u64 begin = start_times_[0].load();
+  for (u32 phase = 1; phase < phases_.size(); phase++) {
+    f64 start_time = phases_[phase].start_time;
+    if (start_time >= execution_time_) {
+      break;
+    }
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+        std::chrono::nanoseconds(begin + (u64)(start_time * 1e9))));
+    markStart(phase);
+    current_.store(phase, std::memory_order_relaxed);
+  }
+}
+
+void Schedule::markStart(u32 _phase) {
+  // Only the first observer of a phase records its start time.
+  u64 unreached = 0;
+  start_times_[_phase].compare_exchange_strong(unreached, wallTime());
+}
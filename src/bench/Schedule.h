@@ -0,0 +1,102 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BENCH_SCHEDULE_H_
+#define BENCH_SCHEDULE_H_
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "des/des.h"
+#include "nlohmann/json.hpp"
+#include "prim/prim.h"
+
+// This class holds a sequence of workload phases. Each phase starts at either
+// a simulated tick or a wall-clock offset (in seconds) from the start of the
+// simulation. Settings not given in a phase are inherited from the previous
+// phase, and the first phase inherits from the component settings.
+class Schedule {
+ public:
+  struct Phase {
+    des::Tick start_tick;
+    f64 start_time;
+    f64 remote_probability;
+    des::Tick look_ahead;
+    u64 events;             // events per active component
+    u64 active_components;  // components with IDs below this are active
+  };
+
+  Schedule(nlohmann::json _settings, nlohmann::json _component_settings,
+           u64 _num_components, f64 _execution_time);
+  ~Schedule() = default;
+
+  bool tickUnits() const;
+  u32 numPhases() const;
+  const Phase& phase(u32 _phase) const;
+
+  // Returns true if event number '_event' of component '_id' does work in
+  // phase '_phase'.
+  bool admits(u32 _phase, u64 _id, u64 _event) const;
+  // Returns the first phase after '_phase' that admits the event, or the
+  // number of phases if there is none.
+  u32 nextAdmitting(u32 _phase, u64 _id, u64 _event) const;
+
+  // Returns the maximum number of events any component uses in any phase.
+  u64 maxEvents() const;
+  // Parked events wake up this often in wall-clock schedules.
+  des::Tick parkInterval() const;
+
+  // Returns the current phase. This is thread safe.
+  u32 current(des::Tick _tick);
+
+  // These are called immediately before and after the simulation.
+  void begin();
+  void end();
+
+  // Prints the throughput of each phase given the event count of each phase.
+  void report(const std::vector<u64>& _counts) const;
+
+ private:
+  void advance();
+  void markStart(u32 _phase);
+
+  const bool tick_units_;
+  const f64 execution_time_;
+  des::Tick park_interval_;
+  std::vector<Phase> phases_;
+
+  std::atomic<u32> current_;
+  std::vector<std::atomic<u64>> start_times_;  // in nanoseconds, 0=unreached
+  u64 end_time_;
+  std::thread advancer_;
+};
+
+#endif  // BENCH_SCHEDULE_H_
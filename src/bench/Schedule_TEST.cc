@@ -0,0 +1,180 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its contributors may be used to
+ * endorse or promote products derived from this software without specific prior
+ * written permission.
+ *
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "bench/Schedule.h"
+
+#include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
+#include "prim/prim.h"
+
+namespace {
+
+nlohmann::json componentSettings() {
+  return nlohmann::json::parse(R"({
+    "type": "empty",
+    "initial_events": 2,
+    "look_ahead": 3,
+    "stagger_tick": false,
+    "stagger_epsilon": false,
+    "remote_probability": 1.0
+  })");
+}
+
+}  // namespace
+
+TEST(Schedule, inherit) {
+  nlohmann::json settings = nlohmann::json::parse(R"({
+    "units": "tick",
+    "phases": [
+      {"start": 0},
+      {"start": 100, "remote_probability": 0.5},
+      {"start": 200, "events": 4, "active_fraction": 0.25},
+      {"start": 300, "look_ahead": 7, "active_fraction": 1.0}
+    ]
+  })");
+  Schedule schedule(settings, componentSettings(), 100, 1.0);
+  ASSERT_TRUE(schedule.tickUnits());
+  ASSERT_EQ(schedule.numPhases(), 4u);
+  ASSERT_EQ(schedule.maxEvents(), 4u);
+
+  // The first phase inherits the component settings.
+  const Schedule::Phase& p0 = schedule.phase(0);
+  ASSERT_EQ(p0.start_tick, 0u);
+  ASSERT_EQ(p0.remote_probability, 1.0);
+  ASSERT_EQ(p0.look_ahead, 3u);
+  ASSERT_EQ(p0.events, 2u);
+  ASSERT_EQ(p0.active_components, 100u);
+
+  // Later phases inherit from the previous phase.
+  const Schedule::Phase& p1 = schedule.phase(1);
+  ASSERT_EQ(p1.start_tick, 100u);
+  ASSERT_EQ(p1.remote_probability, 0.5);
+  ASSERT_EQ(p1.look_ahead, 3u);
+  ASSERT_EQ(p1.events, 2u);
+  ASSERT_EQ(p1.active_components, 100u);
+
+  const Schedule::Phase& p2 = schedule.phase(2);
+  ASSERT_EQ(p2.remote_probability, 0.5);
+  ASSERT_EQ(p2.events, 4u);
+  ASSERT_EQ(p2.active_components, 25u);
+
+  const Schedule::Phase& p3 = schedule.phase(3);
+  ASSERT_EQ(p3.remote_probability, 0.5);
+  ASSERT_EQ(p3.look_ahead, 7u);
+  ASSERT_EQ(p3.events, 4u);
+  ASSERT_EQ(p3.active_components, 100u);
+}
+
+TEST(Schedule, current) {
+  nlohmann::json settings = nlohmann::json::parse(R"({
+    "units": "tick",
+    "phases": [
+      {"start": 0},
+      {"start": 100, "events": 1, "active_fraction": 0.5},
+      {"start": 200, "events": 3, "active_fraction": 1.0}
+    ]
+  })");
+  Schedule schedule(settings, componentSettings(), 10, 1.0);
+  ASSERT_EQ(schedule.current(0), 0u);
+  ASSERT_EQ(schedule.current(99), 0u);
+  ASSERT_EQ(schedule.current(100), 1u);
+  ASSERT_EQ(schedule.current(150), 1u);
+  ASSERT_EQ(schedule.current(1000), 2u);
+
+  // Component 7 is inactive in phase 1 and event 2 is only used in phase 2.
+  ASSERT_TRUE(schedule.admits(0, 7, 1));
+  ASSERT_FALSE(schedule.admits(1, 7, 0));
+  ASSERT_TRUE(schedule.admits(1, 4, 0));
+  ASSERT_FALSE(schedule.admits(1, 4, 1));
+  ASSERT_EQ(schedule.nextAdmitting(0, 7, 0), 2u);
+  ASSERT_EQ(schedule.nextAdmitting(0, 4, 2), 2u);
+  ASSERT_EQ(schedule.nextAdmitting(2, 4, 0), 3u);
+  ASSERT_EQ(schedule.nextAdmitting(0, 4, 3), 3u);
+}
+
+TEST(Schedule, seconds) {
+  nlohmann::json settings = nlohmann::json::parse(R"({
+    "units": "seconds",
+    "park_interval": 50,
+    "phases": [
+      {"start": 0.0},
+      {"start": 0.5, "remote_probability": 0.0}
+    ]
+  })");
+  Schedule schedule(settings, componentSettings(), 10, 1.0);
+  ASSERT_FALSE(schedule.tickUnits());
+  ASSERT_EQ(schedule.parkInterval(), 50u);
+  ASSERT_EQ(schedule.phase(1).start_time, 0.5);
+  ASSERT_EQ(schedule.phase(1).remote_probability, 0.0);
+  ASSERT_EQ(schedule.phase(1).look_ahead, 3u);
+}
+
+TEST(ScheduleDeathTest, startTimes) {
+  // The first phase must start at zero.
+  nlohmann::json late = nlohmann::json::parse(R"({
+    "units": "tick",
+    "phases": [{"start": 5}]
+  })");
+  ASSERT_DEATH(Schedule(late, componentSettings(), 10, 1.0), "");
+
+  // Phases must start in increasing order.
+  nlohmann::json unordered = nlohmann::json::parse(R"({
+    "units": "tick",
+    "phases": [{"start": 0}, {"start": 20}, {"start": 20}]
+  })");
+  ASSERT_DEATH(Schedule(unordered, componentSettings(), 10, 1.0), "");
+
+  nlohmann::json backwards = nlohmann::json::parse(R"({
+    "units": "seconds",
+    "park_interval": 10,
+    "phases": [{"start": 0.0}, {"start": 2.0}, {"start": 1.0}]
+  })");
+  ASSERT_DEATH(Schedule(backwards, componentSettings(), 10, 1.0), "");
+}
+
+TEST(ScheduleDeathTest, invalid) {
+  nlohmann::json units = nlohmann::json::parse(R"({
+    "units": "minutes",
+    "phases": [{"start": 0}]
+  })");
+  ASSERT_DEATH(Schedule(units, componentSettings(), 10, 1.0), "");
+
+  nlohmann::json empty = nlohmann::json::parse(R"({
+    "units": "tick",
+    "phases": []
+  })");
+  ASSERT_DEATH(Schedule(empty, componentSettings(), 10, 1.0), "");
+
+  nlohmann::json fraction = nlohmann::json::parse(R"({
+    "units": "tick",
+    "phases": [{"start": 0, "active_fraction": 1.5}]
+  })");
+  ASSERT_DEATH(Schedule(fraction, componentSettings(), 10, 1.0), "");
+}
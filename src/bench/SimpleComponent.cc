@@ -45,26 +45,39 @@ void SimpleComponent::initialize() {
   u64 initial_events = initialEvents();
   for (u64 e = 0; e < initial_events; e++) {
     simulator->addEvent(new des::Event(
-        this, std::bind(&SimpleComponent::handler, this, -id_, id_, id_),
+        this, std::bind(&SimpleComponent::handler, this, e, -id_, id_, id_),
         des::Time(0), true));
   }
 }
 
-void SimpleComponent::handler(s32 _a, f64 _b, char _c) {
-  count_++;
-  dlogf("hello world, from component #%lu, count %lu", id_, count_);
+void SimpleComponent::handler(u64 _event, s32 _a, f64 _b, char _c) {
+  u32 phase = currentPhase();
+  bool work = admit(_event, phase);
+  if (work) {
+    count_++;
+    dlogf("hello world, from component #%lu, count %lu", id_, count_);
+  }
 
   if (run_) {
-    nextEvent(_a + 1, _b + 1, _c + 1);
+    nextEvent(_event, phase, work, _a + 1, _b + 1, _c + 1);
   }
 }
 
-void SimpleComponent::nextEvent(s32 _a, f64 _b, char _c) {
-  SimpleComponent* component =
-      reinterpret_cast<SimpleComponent*>(nextComponent());
-  des::Time time = nextTime();
+void SimpleComponent::nextEvent(u64 _event, u32 _phase, bool _work, s32 _a,
+                                f64 _b, char _c) {
+  SimpleComponent* component = this;
+  des::Time time;
+  if (_work) {
+    component =
+        reinterpret_cast<SimpleComponent*>(nextComponent(_event, _phase));
+    time = nextTime(_phase);
+  } else if (!parkTime(_event, _phase, &time)) {
+    // No later phase uses this event.
+    return;
+  }
   des::Event* event = new des::Event(
-      component, std::bind(&SimpleComponent::handler, this, _a, _b, _c), time,
+      component,
+      std::bind(&SimpleComponent::handler, this, _event, _a, _b, _c), time,
       true);
   simulator->addEvent(event);
 }
@@ -47,8 +47,9 @@ class SimpleComponent : public BenchComponent {
   void initialize() override;
 
  private:
-  void handler(s32 _a, f64 _b, char _c);
-  void nextEvent(s32 _a, f64 _b, char _c);
+  void handler(u64 _event, s32 _a, f64 _b, char _c);
+  void nextEvent(u64 _event, u32 _phase, bool _work, s32 _a, f64 _b,
+                 char _c);
 };
 
 #endif  // BENCH_SIMPLECOMPONENT_H_
@@ -37,6 +37,8 @@
 #include <vector>
 
 #include "bench/BenchComponent.h"
+#include "bench/PingPongComponent.h"
+#include "bench/Schedule.h"
 #include "des/des.h"
 #include "des/util/BasicObserver.h"
 #include "des/util/RandomMapper.h"
@@ -44,6 +46,7 @@
 #include "nlohmann/json.hpp"
 #include "prim/prim.h"
 #include "settings/settings.h"
+#include "util/PlacementMapper.h"
 
 void executionTimer(std::vector<BenchComponent*>* _components,
                     f64 _execution_time) {
@@ -86,6 +89,8 @@ s32 main(s32 _argc, char** _argv) {
     mapper = new des::RoundRobinMapper();
   } else if (mapper_alg == "random") {
     mapper = new des::RandomMapper();
+  } else if (mapper_alg == "placement") {
+    mapper = new PlacementMapper();
   } else {
     fprintf(stderr, "invalid mapping algorithm: %s\n", mapper_alg.c_str());
     exit(-1);
@@ -120,8 +125,15 @@ s32 main(s32 _argc, char** _argv) {
   }
 
   // Sets the component topology.
+  const std::string component_type =
+      settings["benchmark"]["component"]["type"].get<std::string>();
   const std::string topology =
       settings["benchmark"]["topology"].get<std::string>();
+  if (component_type == "pingpong" && topology != "pairs") {
+    // Other topologies don't return events to their sender.
+    fprintf(stderr, "pingpong components require the pairs topology\n");
+    exit(-1);
+  }
   if (topology == "all-to-all") {
     // All components know about all other components.
     for (u32 id = 0; id < num_components; id++) {
@@ -134,29 +146,101 @@ s32 main(s32 _argc, char** _argv) {
       u32 dst = (src + 1) % num_components;
       components.at(src)->setDestinationComponents({components.at(dst)});
     }
+  } else if (topology == "pairs") {
+    // Each even component is paired with the following odd component.
+    assert(num_components >= 2);
+    assert(num_components % 2 == 0);
+    for (u32 id = 0; id < num_components; id += 2) {
+      components.at(id)->setDestinationComponents({components.at(id + 1)});
+      components.at(id + 1)->setDestinationComponents({components.at(id)});
+    }
   } else {
     fprintf(stderr, "Unknown topology name: %s\n", topology.c_str());
     assert(false);
   }
 
+  // Places the components on their chosen executers.
+  if (mapper_alg == "placement") {
+    const nlohmann::json& placement =
+        settings["simulator"]["mapper"]["placement"];
+    assert(placement.size() == num_components);
+    PlacementMapper* placement_mapper = dynamic_cast<PlacementMapper*>(mapper);
+    for (u32 id = 0; id < num_components; id++) {
+      placement_mapper->place(components.at(id), placement[id].get<u32>());
+    }
+
+    // Optionally pins each executer to a CPU (pingpong components only).
+    if (settings["simulator"]["mapper"].contains("cpus")) {
+      const nlohmann::json& cpus = settings["simulator"]["mapper"]["cpus"];
+      assert(cpus.size() == num_executers);
+      if (component_type != "pingpong") {
+        fprintf(stderr, "executer cpus are only supported by pingpong\n");
+        exit(-1);
+      }
+      for (u32 id = 0; id < num_components; id++) {
+        u32 executer = placement[id].get<u32>();
+        dynamic_cast<PingPongComponent*>(components.at(id))
+            ->setCpu(cpus[executer].get<s32>());
+      }
+    }
+  }
+
   // Checks that all components to be debugged were found.
   sim->debugNameCheck();
 
-  // Create a killer thread that stops the components from running forever.
+  // Creates the optional workload schedule.
   f64 execution_time = settings["simulator"]["execution_time"].get<f64>();
   assert(execution_time >= 0.0);
+  Schedule* schedule = nullptr;
+  if (settings["benchmark"].contains("schedule")) {
+    if (component_type == "pingpong") {
+      fprintf(stderr, "schedules are not supported by pingpong components\n");
+      exit(-1);
+    }
+    schedule = new Schedule(settings["benchmark"]["schedule"],
+                            settings["benchmark"]["component"], num_components,
+                            execution_time);
+    for (u32 id = 0; id < num_components; id++) {
+      components.at(id)->setSchedule(schedule);
+    }
+  }
+
+  // Create a killer thread that stops the components from running forever.
   std::thread killer(executionTimer, &components, execution_time);
 
   // Runs the simulation.
+  if (schedule != nullptr) {
+    schedule->begin();
+  }
   sim->simulate();
+  if (schedule != nullptr) {
+    schedule->end();
+  }
 
   // Joins the killer thread which has already completed.
   killer.join();
 
+  // Reports the throughput of each phase.
+  if (schedule != nullptr) {
+    std::vector<u64> phase_counts(schedule->numPhases(), 0);
+    for (u32 id = 0; id < num_components; id++) {
+      for (u32 phase = 0; phase < schedule->numPhases(); phase++) {
+        phase_counts.at(phase) += components.at(id)->phaseCount(phase);
+      }
+    }
+    schedule->report(phase_counts);
+  }
+
+  // Reports the component specific results.
+  for (u32 id = 0; id < num_components; id++) {
+    components.at(id)->report();
+  }
+
   // Cleans up all memory.
   for (u32 id = 0; id < num_components; id++) {
     delete components.at(id);
   }
+  delete schedule;
   delete log;
   delete ob;
   delete sim;